@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+# Stands in for gpg, oathtool and pass in the tests, no keys needed. The entry
+# is taken from the path of the ".gpg" file (gpg) or the last argument (pass).
+#
+#   <entry>            decrypts to "secret-<entry>" and a second line
+#   totp::*            contains an otpauth://totp URI, oathtool prints a fixed code
+#   totp-digits::*     asks for 8 digits, percent-encoded
+#   totp-issuer::*     has an issuer, which the helper leaves to pass-otp
+#   totp-broken::*     has a secret oathtool fails on
+#   hotp::*            contains an otpauth://hotp URI
+#   missing*           fails like a non existing entry
+#   slow*              takes a while to "decrypt"
+#   crash*             kills the helper that started us
+#   crash-once*        kills the helper only on the first call, marker in $FAKE_PASS_STATE
+
+case "$1" in
+    --base32)
+        [ "${!#}" = AAAAAAAA ] && exit 1
+        digits=6
+        for arg in "$@"; do
+            [[ $arg == --digits=* ]] && digits=${arg#--digits=}
+        done
+        echo 12345678 | cut -c 1-"$digits"
+        exit 0
+        ;;
+    show|otp)
+        mode=pass
+        entry=${!#}
+        ;;
+    *)
+        entry=${!#}
+        entry=${entry#"$PASSWORD_STORE_DIR"/}
+        entry=${entry%.gpg}
+        ;;
+esac
+
+case "$entry" in
+    missing*)
+        echo "gpg: can't open '$entry.gpg': No such file or directory" >&2
+        exit 2
+        ;;
+    slow*)
+        sleep 0.2
+        ;;
+    crash-once*)
+        if [ ! -e "$FAKE_PASS_STATE/crashed" ]; then
+            touch "$FAKE_PASS_STATE/crashed"
+            kill -9 $PPID
+            exit 2
+        fi
+        ;;
+    crash*)
+        kill -9 $PPID
+        exit 2
+        ;;
+esac
+
+if [ "$mode" = pass ]; then
+    printf 'pass-%s\n' "$entry"
+elif [[ $entry == totp::* ]]; then
+    printf 'otpauth://totp/%s?secret=JBSWY3DPEHPK3PXP\n' "$entry"
+elif [[ $entry == totp-digits::* ]]; then
+    printf 'otpauth://totp/%s?secret=JBSWY3DPEHPK3PXP&digits=%%38\n' "$entry"
+elif [[ $entry == totp-issuer::* ]]; then
+    printf 'otpauth://totp/%s?secret=JBSWY3DPEHPK3PXP&issuer=kde\n' "$entry"
+elif [[ $entry == totp-broken::* ]]; then
+    printf 'otpauth://totp/%s?secret=AAAAAAAA\n' "$entry"
+elif [[ $entry == hotp::* ]]; then
+    printf 'otpauth://hotp/%s?secret=JBSWY3DPEHPK3PXP&counter=3\n' "$entry"
+else
+    printf 'secret-%s\nuser: alice\n' "$entry"
+fi
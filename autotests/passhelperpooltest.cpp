@@ -0,0 +1,243 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "passhelperpool.h"
+
+// Runs the real helper script, with fakegpg.sh standing in for gpg, oathtool and pass
+class PassHelperPoolTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void testShow();
+    void testOtp();
+    void testOtpLeftToPass();
+    void testHotpUnsupported();
+    void testExtensionCommand();
+    void testMissingEntry();
+    void testConcurrentRequests();
+    void testCrashRespawns();
+    void testCrashTwiceFails();
+    void testOtpCrashNotRetried();
+    void testIdleRecycle();
+    void testCancel();
+    void testHelperNotFound();
+
+private:
+    PassHelperPool *createPool(const QString &program = QStringLiteral(HELPER_PATH),
+                               const QString &command = QString());
+    PassHelperPool::Reply request(PassHelperPool *pool, const QString &entry,
+                                  PassHelperPool::Mode mode = PassHelperPool::Mode::Show);
+
+    QScopedPointer<QTemporaryDir> state;
+    QScopedPointer<PassHelperPool> pool;
+};
+
+void PassHelperPoolTest::init()
+{
+    state.reset(new QTemporaryDir);
+    QVERIFY(state->isValid());
+    pool.reset(createPool());
+}
+
+PassHelperPool *PassHelperPoolTest::createPool(const QString &program, const QString &command)
+{
+    auto environment = QProcessEnvironment::systemEnvironment();
+    environment.insert(QStringLiteral("PASSWORD_STORE_DIR"), state->path());
+    environment.insert(QStringLiteral("KRUNNER_PASS_GPG"), QStringLiteral(FAKE_GPG_PATH));
+    environment.insert(QStringLiteral("KRUNNER_PASS_OATHTOOL"), QStringLiteral(FAKE_GPG_PATH));
+    environment.insert(QStringLiteral("FAKE_PASS_STATE"), state->path());
+    if (command.isEmpty()) {
+        environment.remove(QStringLiteral("KRUNNER_PASS_COMMAND"));
+    } else {
+        environment.insert(QStringLiteral("KRUNNER_PASS_COMMAND"), command);
+    }
+
+    auto *result = new PassHelperPool(program);
+    result->setProcessEnvironment(environment);
+    return result;
+}
+
+PassHelperPool::Reply PassHelperPoolTest::request(PassHelperPool *pool, const QString &entry, PassHelperPool::Mode mode)
+{
+    PassHelperPool::Reply result;
+    bool done = false;
+    pool->request(entry, mode, [&](const PassHelperPool::Reply &reply) {
+        result = reply;
+        done = true;
+    });
+    [&]() {
+        QTRY_VERIFY_WITH_TIMEOUT(done, 5000);
+    }();
+    return result;
+}
+
+void PassHelperPoolTest::testShow()
+{
+    pool->warmUp();
+    const auto reply = request(pool.data(), QStringLiteral("web/git hub ü"));
+    QCOMPARE(reply.exitCode, 0);
+    QCOMPARE(reply.output, QStringLiteral("secret-web/git hub ü\nuser: alice\n").toUtf8());
+
+    // The warm helper is reused
+    QCOMPARE(request(pool.data(), QStringLiteral("mail")).exitCode, 0);
+    QCOMPARE(pool->spawnedHelpers(), 1);
+}
+
+void PassHelperPoolTest::testOtp()
+{
+    const auto reply = request(pool.data(), QStringLiteral("totp::github"), PassHelperPool::Mode::Otp);
+    QCOMPARE(reply.exitCode, 0);
+    QCOMPARE(reply.output, QByteArray("123456\n"));
+
+    // Parameters are percent-decoded
+    const auto digits = request(pool.data(), QStringLiteral("totp-digits::github"), PassHelperPool::Mode::Otp);
+    QCOMPARE(digits.exitCode, 0);
+    QCOMPARE(digits.output, QByteArray("12345678\n"));
+}
+
+void PassHelperPoolTest::testOtpLeftToPass()
+{
+    // Unknown parameters and oathtool failures are left to pass-otp
+    for (const auto &entry: {QStringLiteral("totp-issuer::github"), QStringLiteral("totp-broken::github")}) {
+        const auto reply = request(pool.data(), entry, PassHelperPool::Mode::Otp);
+        QCOMPARE(reply.exitCode, -1);
+        QVERIFY(!reply.crashed);
+    }
+}
+
+void PassHelperPoolTest::testHotpUnsupported()
+{
+    // Left to pass-otp, which has to update the counter
+    const auto reply = request(pool.data(), QStringLiteral("hotp::bank"), PassHelperPool::Mode::Otp);
+    QCOMPARE(reply.exitCode, -1);
+    QVERIFY(!reply.crashed);
+    QVERIFY(reply.output.isEmpty());
+}
+
+void PassHelperPoolTest::testExtensionCommand()
+{
+    pool.reset(createPool(QStringLiteral(HELPER_PATH), QStringLiteral(FAKE_GPG_PATH)));
+    const auto reply = request(pool.data(), QStringLiteral("web/github"));
+    QCOMPARE(reply.exitCode, 0);
+    QCOMPARE(reply.output, QByteArray("pass-web/github\n"));
+}
+
+void PassHelperPoolTest::testMissingEntry()
+{
+    const auto reply = request(pool.data(), QStringLiteral("missing"));
+    QCOMPARE(reply.exitCode, 2);
+    QVERIFY(reply.output.isEmpty());
+    QCOMPARE(request(pool.data(), QStringLiteral("mail")).exitCode, 0);
+
+    QCOMPARE(request(pool.data(), QStringLiteral("two\nlines")).exitCode, -1);
+}
+
+void PassHelperPoolTest::testConcurrentRequests()
+{
+    pool->setMaxHelpers(2);
+    int replies = 0;
+    for (int i = 0; i < 6; ++i) {
+        const auto entry = QStringLiteral("slow-%1").arg(i);
+        pool->request(entry, PassHelperPool::Mode::Show, [&replies, entry](const PassHelperPool::Reply &reply) {
+            QCOMPARE(reply.exitCode, 0);
+            QCOMPARE(reply.output, QStringLiteral("secret-%1\nuser: alice\n").arg(entry).toUtf8());
+            ++replies;
+        });
+    }
+    QCOMPARE(pool->helperCount(), 2);
+    QTRY_COMPARE_WITH_TIMEOUT(replies, 6, 5000);
+    QCOMPARE(pool->spawnedHelpers(), 2);
+}
+
+void PassHelperPoolTest::testCrashRespawns()
+{
+    const auto reply = request(pool.data(), QStringLiteral("crash-once"));
+    QCOMPARE(reply.exitCode, 0);
+    QCOMPARE(reply.output, QByteArray("secret-crash-once\nuser: alice\n"));
+    QCOMPARE(pool->spawnedHelpers(), 2);
+    QCOMPARE(pool->helperCount(), 1);
+}
+
+void PassHelperPoolTest::testCrashTwiceFails()
+{
+    const auto reply = request(pool.data(), QStringLiteral("crash"));
+    QCOMPARE(reply.exitCode, -1);
+    QVERIFY(reply.crashed);
+    // Two crashed helpers and a warm replacement for the next request
+    QCOMPARE(pool->spawnedHelpers(), 3);
+    QCOMPARE(pool->helperCount(), 1);
+    QCOMPARE(request(pool.data(), QStringLiteral("mail")).exitCode, 0);
+    QCOMPARE(pool->spawnedHelpers(), 3);
+}
+
+void PassHelperPoolTest::testOtpCrashNotRetried()
+{
+    const auto reply = request(pool.data(), QStringLiteral("crash-once"), PassHelperPool::Mode::Otp);
+    QCOMPARE(reply.exitCode, -1);
+    QVERIFY(reply.crashed);
+    // Replaced, but the request was not run again
+    QCOMPARE(pool->spawnedHelpers(), 2);
+    QCOMPARE(pool->helperCount(), 1);
+}
+
+void PassHelperPoolTest::testIdleRecycle()
+{
+    pool->setIdleTimeout(100);
+    pool->warmUp();
+    QCOMPARE(pool->helperCount(), 1);
+
+    // The idle helper is replaced by a fresh one, so one stays warm
+    QTRY_VERIFY_WITH_TIMEOUT(pool->spawnedHelpers() >= 2, 5000);
+    QCOMPARE(pool->helperCount(), 1);
+    QCOMPARE(request(pool.data(), QStringLiteral("mail")).exitCode, 0);
+}
+
+void PassHelperPoolTest::testCancel()
+{
+    bool called = false;
+    pool->request(QStringLiteral("slow"), PassHelperPool::Mode::Show, [&called](const PassHelperPool::Reply &) {
+        called = true;
+    });
+    pool->request(QStringLiteral("mail"), PassHelperPool::Mode::Show, [&called](const PassHelperPool::Reply &) {
+        called = true;
+    });
+    pool->cancel();
+
+    QTest::qWait(500);
+    QVERIFY(!called);
+    // No replacements either
+    pool->warmUp();
+    QCOMPARE(pool->spawnedHelpers(), 2);
+}
+
+void PassHelperPoolTest::testHelperNotFound()
+{
+    QScopedPointer<PassHelperPool> broken(createPool(QStringLiteral("/nonexistent/krunner-pass-helper")));
+    QCOMPARE(request(broken.data(), QStringLiteral("mail")).exitCode, -1);
+    QCOMPARE(broken->helperCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(PassHelperPoolTest)
+
+#include "passhelperpooltest.moc"
@@ -0,0 +1,135 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#include <QTest>
+
+#include "passstats.h"
+
+class PassStatsTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testBucketEdges_data();
+    void testBucketEdges();
+    void testPercentiles();
+    void testReset();
+    void testCounters();
+};
+
+void PassStatsTest::testBucketEdges_data()
+{
+    QTest::addColumn<qint64>("nsecs");
+    QTest::addColumn<quint64>("upperBoundUs");
+
+    // Bucket i holds [2^(i-1), 2^i) microseconds, bucket 0 everything below 1us
+    QTest::newRow("negative") << qint64(-5) << quint64(1);
+    QTest::newRow("zero") << qint64(0) << quint64(1);
+    QTest::newRow("below 1us") << qint64(999) << quint64(1);
+    QTest::newRow("1us") << qint64(1000) << quint64(2);
+    QTest::newRow("below 2us") << qint64(1999) << quint64(2);
+    QTest::newRow("2us") << qint64(2000) << quint64(4);
+    QTest::newRow("below 4us") << qint64(3999) << quint64(4);
+    QTest::newRow("4us") << qint64(4000) << quint64(8);
+    QTest::newRow("1023us") << qint64(1023000) << quint64(1024);
+    QTest::newRow("1024us") << qint64(1024000) << quint64(2048);
+    QTest::newRow("last bucket") << (qint64(1) << 40) << (quint64(1) << 31);
+}
+
+void PassStatsTest::testBucketEdges()
+{
+    QFETCH(qint64, nsecs);
+    QFETCH(quint64, upperBoundUs);
+
+    LatencyHistogram histogram;
+    histogram.record(nsecs);
+    QCOMPARE(histogram.count(), quint64(1));
+    QCOMPARE(histogram.percentileUs(0.50), upperBoundUs);
+    QCOMPARE(histogram.percentileUs(0.99), upperBoundUs);
+}
+
+void PassStatsTest::testPercentiles()
+{
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.percentileUs(0.50), quint64(0));
+
+    // p99 of 100 samples is the 99th smallest one
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(10000);
+    }
+    histogram.record(5000000);
+    QCOMPARE(histogram.percentileUs(0.50), quint64(16));
+    QCOMPARE(histogram.percentileUs(0.99), quint64(16));
+
+    histogram.reset();
+    for (int i = 0; i < 98; ++i) {
+        histogram.record(10000);
+    }
+    histogram.record(5000000);
+    histogram.record(5000000);
+    QCOMPARE(histogram.percentileUs(0.50), quint64(16));
+    QCOMPARE(histogram.percentileUs(0.99), quint64(8192));
+    QCOMPARE(histogram.percentileUs(1.0), quint64(8192));
+
+    const auto map = histogram.toVariantMap();
+    QCOMPARE(map.value(QStringLiteral("count")).toULongLong(), quint64(100));
+    QCOMPARE(map.value(QStringLiteral("max_us")).toULongLong(), quint64(5000));
+    QCOMPARE(map.value(QStringLiteral("avg_us")).toULongLong(), quint64(109));
+    QCOMPARE(map.value(QStringLiteral("p50_us")).toULongLong(), quint64(16));
+}
+
+void PassStatsTest::testReset()
+{
+    LatencyHistogram histogram;
+    histogram.record(5000000);
+    histogram.reset();
+
+    QCOMPARE(histogram.count(), quint64(0));
+    QCOMPARE(histogram.percentileUs(0.99), quint64(0));
+    QCOMPARE(histogram.toVariantMap().value(QStringLiteral("max_us")).toULongLong(), quint64(0));
+
+    histogram.record(1000);
+    QCOMPARE(histogram.count(), quint64(1));
+    QCOMPARE(histogram.percentileUs(0.99), quint64(2));
+}
+
+void PassStatsTest::testCounters()
+{
+    PassStats stats;
+    stats.queries = 3;
+    stats.rejectedQueries = 1;
+    stats.indexEntries = 42;
+    stats.match.record(10000);
+
+    auto counters = stats.Counters();
+    QCOMPARE(counters.value(QStringLiteral("queries")).toULongLong(), quint64(3));
+    QCOMPARE(counters.value(QStringLiteral("queries_rejected")).toULongLong(), quint64(1));
+    QCOMPARE(counters.value(QStringLiteral("match")).toMap().value(QStringLiteral("count")).toULongLong(), quint64(1));
+
+    // Gauges of the current index survive a reset
+    stats.Reset();
+    counters = stats.Counters();
+    QCOMPARE(counters.value(QStringLiteral("queries")).toULongLong(), quint64(0));
+    QCOMPARE(counters.value(QStringLiteral("queries_rejected")).toULongLong(), quint64(0));
+    QCOMPARE(counters.value(QStringLiteral("match")).toMap().value(QStringLiteral("count")).toULongLong(), quint64(0));
+    QCOMPARE(counters.value(QStringLiteral("index_entries")).toULongLong(), quint64(42));
+}
+
+QTEST_GUILESS_MAIN(PassStatsTest)
+
+#include "passstatstest.moc"
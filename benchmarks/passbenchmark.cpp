@@ -0,0 +1,284 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+// Replays a keystroke query log against Pass::match() on a synthetic (or
+// existing) password store and reports latency percentiles, throughput and
+// peak RSS. Nothing is decrypted, the generated ".gpg" files are empty, and
+// neither the helper processes nor the D-Bus statistics are used.
+
+#include <KPluginMetaData>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <KRunner/RunnerContext>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "pass.h"
+#include "storegenerator.h"
+
+namespace {
+class BenchmarkPass : public Pass
+{
+public:
+    BenchmarkPass()
+        : Pass(nullptr, KPluginMetaData(), QVariantList())
+    {
+        inKRunner = false;
+    }
+
+    using Pass::init;
+    using Pass::initPasswords;
+    using Pass::statistics;
+};
+
+struct Samples {
+    std::vector<qint64> nsecs;
+
+    double percentile(double p)
+    {
+        if (nsecs.empty()) {
+            return 0;
+        }
+        std::sort(nsecs.begin(), nsecs.end());
+        const auto index = std::min(nsecs.size() - 1, size_t(p * nsecs.size()));
+        return nsecs[index] / 1000.0;
+    }
+
+    double meanUs() const
+    {
+        if (nsecs.empty()) {
+            return 0;
+        }
+        qint64 total = 0;
+        for (const auto n: nsecs) {
+            total += n;
+        }
+        return total / 1000.0 / nsecs.size();
+    }
+};
+
+void report(const char *name, Samples &samples, const QString &extra = QString())
+{
+    printf("%-16s n=%-8zu p50=%10.1fus p99=%10.1fus mean=%10.1fus %s\n", name, samples.nsecs.size(),
+           samples.percentile(0.50), samples.percentile(0.99), samples.meanUs(), qPrintable(extra));
+}
+
+long peakRssKiB()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Reads a "<field>: <n> kB" line of /proc/self/status, -1 if not available
+long procStatusKiB(const char *field)
+{
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const auto prefix = QByteArray(field) + ':';
+    const auto lines = file.readAll().split('\n');
+    for (const auto &line: lines) {
+        if (line.startsWith(prefix)) {
+            return line.mid(prefix.size()).simplified().split(' ').value(0).toLong();
+        }
+    }
+    return -1;
+}
+
+// Lets VmHWM start over from the current RSS, Linux only
+bool resetPeakRss()
+{
+    QFile file(QStringLiteral("/proc/self/clear_refs"));
+    return file.open(QIODevice::WriteOnly) && file.write("5") == 1;
+}
+
+QStringList readQueryLog(const QString &path)
+{
+    QStringList queries;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "Could not open query log" << path << file.errorString();
+        return queries;
+    }
+    QTextStream stream(&file);
+    while (!stream.atEnd()) {
+        const auto line = stream.readLine();
+        if (!line.startsWith(QLatin1Char('#'))) {
+            queries << line;
+        }
+    }
+    return queries;
+}
+}
+
+int main(int argc, char **argv)
+{
+    // Pass::match() loads icons, we only need a QGuiApplication without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    QApplication::setApplicationName(QStringLiteral("passbenchmark"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Replays a keystroke query log against the pass runner"));
+    parser.addHelpOption();
+    const QCommandLineOption storeOption(QStringLiteral("store"), QStringLiteral("Use an existing store instead of generating one."), QStringLiteral("dir"));
+    const QCommandLineOption generateOption(QStringLiteral("generate"), QStringLiteral("Only generate a synthetic store into <dir> and exit."), QStringLiteral("dir"));
+    const QCommandLineOption entriesOption(QStringLiteral("entries"), QStringLiteral("Number of generated entries."), QStringLiteral("n"), QStringLiteral("10000"));
+    const QCommandLineOption depthOption(QStringLiteral("depth"), QStringLiteral("Directory depth of the generated store."), QStringLiteral("n"), QStringLiteral("3"));
+    const QCommandLineOption fanOutOption(QStringLiteral("fanout"), QStringLiteral("Sub directories per directory."), QStringLiteral("n"), QStringLiteral("6"));
+    const QCommandLineOption seedOption(QStringLiteral("seed"), QStringLiteral("Seed for the generator."), QStringLiteral("n"), QStringLiteral("1"));
+    const QCommandLineOption queriesOption(QStringLiteral("queries"), QStringLiteral("Keystroke log, one query state per line."), QStringLiteral("file"));
+    const QCommandLineOption sessionsOption(QStringLiteral("sessions"), QStringLiteral("Typing sessions to synthesize when no log is given."), QStringLiteral("n"), QStringLiteral("200"));
+    const QCommandLineOption roundsOption(QStringLiteral("rounds"), QStringLiteral("How often the query log is replayed."), QStringLiteral("n"), QStringLiteral("3"));
+    const QCommandLineOption rebuildsOption(QStringLiteral("rebuilds"), QStringLiteral("Number of timed initPasswords() and reinitPasswords() calls."), QStringLiteral("n"), QStringLiteral("10"));
+    parser.addOptions({storeOption, generateOption, entriesOption, depthOption, fanOutOption, seedOption,
+                       queriesOption, sessionsOption, roundsOption, rebuildsOption});
+    parser.process(app);
+
+    StoreGenerator generator;
+    generator.entries = parser.value(entriesOption).toInt();
+    generator.depth = parser.value(depthOption).toInt();
+    generator.fanOut = parser.value(fanOutOption).toInt();
+    generator.seed = parser.value(seedOption).toUInt();
+
+    if (parser.isSet(generateOption)) {
+        const QDir dir(parser.value(generateOption));
+        dir.mkpath(QStringLiteral("."));
+        const auto entries = generator.generate(dir);
+        printf("Generated %lld entries in %s\n", qint64(entries.size()), qPrintable(dir.absolutePath()));
+        return 0;
+    }
+
+    QTemporaryDir tempDir;
+    QString storePath = parser.value(storeOption);
+    QStringList entries;
+    if (storePath.isEmpty()) {
+        if (!tempDir.isValid()) {
+            qWarning() << "Could not create temporary directory" << tempDir.errorString();
+            return 1;
+        }
+        storePath = tempDir.path();
+        QElapsedTimer timer;
+        timer.start();
+        entries = generator.generate(QDir(storePath));
+        printf("Generated %lld entries (depth %d, fan-out %d) in %lld ms\n", qint64(entries.size()),
+               generator.depth, generator.fanOut, timer.elapsed());
+    }
+    qputenv("PASSWORD_STORE_DIR", QFile::encodeName(storePath));
+
+    QStringList queries;
+    if (parser.isSet(queriesOption)) {
+        queries = readQueryLog(parser.value(queriesOption));
+    } else {
+        if (entries.isEmpty()) {
+            // Existing store, collect the names the same way the runner does
+            const QDir baseDir(storePath);
+            QDirIterator it(storePath, {QStringLiteral("*.gpg")}, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                auto entry = baseDir.relativeFilePath(it.next());
+                entry.chop(4);
+                entries << entry;
+            }
+        }
+        queries = StoreGenerator::keystrokeLog(entries, parser.value(sessionsOption).toInt(), generator.seed);
+    }
+
+    // Only the runner index should count towards the memory figure
+    entries = QStringList();
+
+    // The generator's and the query log's memory is resident already, the
+    // index is measured on top of it
+    BenchmarkPass pass;
+    const auto baselineRss = procStatusKiB("VmRSS");
+    const bool peakReset = resetPeakRss();
+
+    // Also reads the runner configuration, not part of the timings
+    pass.init();
+
+    const int rebuilds = parser.value(rebuildsOption).toInt();
+    Samples initSamples;
+    QElapsedTimer timer;
+    for (int i = 0; i < rebuilds; ++i) {
+        timer.start();
+        pass.initPasswords();
+        initSamples.nsecs.push_back(timer.nsecsElapsed());
+    }
+    report("initPasswords", initSamples,
+           QStringLiteral("entries=%1 watches=%2").arg(pass.statistics().indexEntries.load()).arg(pass.statistics().indexWatches.load()));
+
+    // Same as initPasswords() plus the write lock, like a watcher event
+    Samples reinitSamples;
+    for (int i = 0; i < rebuilds; ++i) {
+        timer.start();
+        pass.reinitPasswords(storePath);
+        reinitSamples.nsecs.push_back(timer.nsecsElapsed());
+    }
+    report("reinitPasswords", reinitSamples);
+    if (peakReset && baselineRss >= 0) {
+        printf("index: %ld KiB peak RSS on top of %ld KiB before init()\n", procStatusKiB("VmHWM") - baselineRss, baselineRss);
+    } else {
+        printf("index: peak RSS can not be reset on this system\n");
+    }
+
+    // Queries match() turns down right away (one or two characters) are kept
+    // out of the percentiles, they would only pull p50 down
+    Samples matchSamples;
+    Samples rejectedSamples;
+    qint64 hits = 0;
+    QElapsedTimer wallClock;
+    wallClock.start();
+    for (int round = 0, rounds = parser.value(roundsOption).toInt(); round < rounds; ++round) {
+        for (const auto &query: qAsConst(queries)) {
+            KRunner::RunnerContext context;
+            context.setQuery(query);
+            const auto rejected = pass.statistics().rejectedQueries.load();
+            timer.start();
+            pass.match(context);
+            const auto nsecs = timer.nsecsElapsed();
+            if (pass.statistics().rejectedQueries.load() != rejected) {
+                rejectedSamples.nsecs.push_back(nsecs);
+            } else {
+                matchSamples.nsecs.push_back(nsecs);
+                hits += context.matches().size();
+            }
+        }
+    }
+    const auto seconds = wallClock.nsecsElapsed() / 1e9;
+    report("match", matchSamples, QStringLiteral("hits=%1").arg(hits));
+    report("match rejected", rejectedSamples);
+    printf("replay: %.1f queries/s wall clock, including rejected queries and RunnerContext setup\n",
+           seconds > 0 ? (matchSamples.nsecs.size() + rejectedSamples.nsecs.size()) / seconds : 0.0);
+
+    printf("peak RSS: %ld KiB for the whole process, including the store generator\n", peakRssKiB());
+    return 0;
+}
@@ -0,0 +1,177 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#include <QDebug>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSet>
+
+#include <random>
+
+#include "storegenerator.h"
+
+namespace {
+const QStringList categories = {
+    QStringLiteral("web"), QStringLiteral("email"), QStringLiteral("servers"), QStringLiteral("banking"),
+    QStringLiteral("work"), QStringLiteral("social"), QStringLiteral("shopping"), QStringLiteral("dev"),
+    QStringLiteral("family"), QStringLiteral("wifi"), QStringLiteral("games"), QStringLiteral("cloud"),
+};
+
+const QStringList services = {
+    QStringLiteral("github.com"), QStringLiteral("gitlab.com"), QStringLiteral("invent.kde.org"),
+    QStringLiteral("amazon.de"), QStringLiteral("amazon.com"), QStringLiteral("ebay.com"), QStringLiteral("paypal.com"),
+    QStringLiteral("google.com"), QStringLiteral("mail.google.com"), QStringLiteral("outlook.com"),
+    QStringLiteral("posteo.de"), QStringLiteral("mailbox.org"), QStringLiteral("protonmail.com"),
+    QStringLiteral("twitter.com"), QStringLiteral("mastodon.social"), QStringLiteral("reddit.com"),
+    QStringLiteral("facebook.com"), QStringLiteral("linkedin.com"), QStringLiteral("netflix.com"),
+    QStringLiteral("spotify.com"), QStringLiteral("steampowered.com"), QStringLiteral("dropbox.com"),
+    QStringLiteral("nextcloud"), QStringLiteral("aws-console"), QStringLiteral("digitalocean.com"),
+    QStringLiteral("hetzner.com"), QStringLiteral("ovh.net"), QStringLiteral("cloudflare.com"),
+    QStringLiteral("db-prod"), QStringLiteral("db-staging"), QStringLiteral("vpn"), QStringLiteral("router"),
+    QStringLiteral("nas"), QStringLiteral("jenkins"), QStringLiteral("grafana"), QStringLiteral("sentry.io"),
+    QStringLiteral("n26.com"), QStringLiteral("dkb.de"), QStringLiteral("ing.de"), QStringLiteral("sparkasse"),
+    QStringLiteral("wikipedia.org"), QStringLiteral("stackoverflow.com"), QStringLiteral("npmjs.com"),
+    QStringLiteral("pypi.org"), QStringLiteral("crates.io"), QStringLiteral("docker.com"),
+};
+
+const QStringList users = {
+    QStringLiteral("alice"), QStringLiteral("bob"), QStringLiteral("j.doe"), QStringLiteral("admin"),
+    QStringLiteral("root"), QStringLiteral("deploy"), QStringLiteral("lukas"), QStringLiteral("maria.schmidt"),
+    QStringLiteral("backup"), QStringLiteral("ci-bot"), QStringLiteral("guest"), QStringLiteral("kim"),
+};
+
+QString pick(const QStringList &list, std::mt19937 &rng)
+{
+    return list.at(std::uniform_int_distribution<int>(0, int(list.size()) - 1)(rng));
+}
+
+QString nthName(const QStringList &pool, int n)
+{
+    const auto name = pool.at(n % pool.size());
+    return n < pool.size() ? name : name + QLatin1Char('-') + QString::number(n / pool.size());
+}
+}
+
+QStringList StoreGenerator::generate(const QDir &baseDir) const
+{
+    std::mt19937 rng(seed);
+
+    // Directory tree, the root of the store is a valid location as well
+    QStringList dirs = {QString()};
+    QStringList level = {QString()};
+    for (int d = 0; d < depth; ++d) {
+        QStringList next;
+        const auto &pool = d == 0 ? categories : services;
+        for (const auto &parent: qAsConst(level)) {
+            for (int i = 0; i < fanOut; ++i) {
+                const auto name = nthName(pool, i);
+                next << (parent.isEmpty() ? name : parent + QLatin1Char('/') + name);
+            }
+        }
+        dirs << next;
+        level = next;
+    }
+    for (const auto &dir: qAsConst(dirs)) {
+        baseDir.mkpath(dir.isEmpty() ? QStringLiteral(".") : dir);
+    }
+
+    QStringList result;
+    QSet<QString> seen;
+    result.reserve(entries);
+    seen.reserve(entries);
+    std::uniform_int_distribution<int> dirDist(0, int(dirs.size()) - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    for (int i = 0; i < entries; ++i) {
+        const auto &dir = dirs.at(dirDist(rng));
+        const auto service = pick(services, rng);
+        const auto user = pick(users, rng);
+
+        QString name;
+        switch (percent(rng) % 3) {
+        case 0:
+            name = service;
+            break;
+        case 1:
+            name = user + QLatin1Char('@') + service;
+            break;
+        default:
+            name = service + QLatin1Char('-') + user;
+            break;
+        }
+        if (percent(rng) < 5) {
+            name.prepend(otpIdentifier);
+        }
+
+        QString entry = dir.isEmpty() ? name : dir + QLatin1Char('/') + name;
+        if (seen.contains(entry)) {
+            entry += QLatin1Char('-') + QString::number(i);
+        }
+        seen.insert(entry);
+
+        QFile file(baseDir.filePath(entry + QStringLiteral(".gpg")));
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "Could not create" << file.fileName() << file.errorString();
+            continue;
+        }
+        file.close();
+        result << entry;
+    }
+
+    return result;
+}
+
+QStringList StoreGenerator::keystrokeLog(const QStringList &entries, int sessions, quint32 seed)
+{
+    QStringList log;
+    if (entries.isEmpty()) {
+        return log;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> entryDist(0, int(entries.size()) - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    for (int s = 0; s < sessions; ++s) {
+        // Users type a part of the last path component, e.g. "github"
+        auto target = entries.at(entryDist(rng)).section(QLatin1Char('/'), -1);
+        target.remove(QRegularExpression(QStringLiteral("^[^:]*::")));
+        const int maxLength = qMin(int(target.size()), 12);
+        const int length = std::uniform_int_distribution<int>(qMin(3, maxLength), maxLength)(rng);
+        const int offset = percent(rng) < 70 ? 0 : std::uniform_int_distribution<int>(0, int(target.size()) - length)(rng);
+        const auto fragment = target.mid(offset, length);
+
+        QString query;
+        if (percent(rng) < 20) {
+            for (const auto c: QStringLiteral("pass ")) {
+                query += c;
+                log << query;
+            }
+        }
+        for (const auto c: fragment) {
+            if (percent(rng) < 5) {
+                // Typo followed by a backspace
+                log << query + QLatin1Char('x') << query;
+            }
+            query += c;
+            log << query;
+        }
+    }
+
+    return log;
+}
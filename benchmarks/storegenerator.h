@@ -0,0 +1,44 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#ifndef STOREGENERATOR_H
+#define STOREGENERATOR_H
+
+#include <QDir>
+#include <QStringList>
+
+// Creates a synthetic password store with empty ".gpg" files. Entries are
+// spread over a directory tree that is `depth` levels deep with `fanOut`
+// sub directories per level, names are drawn from a list of common services
+// and account names so substring queries behave like on a real store.
+struct StoreGenerator {
+    int entries = 10000;
+    int depth = 3;
+    int fanOut = 6;
+    quint32 seed = 1;
+    QString otpIdentifier = QStringLiteral("totp::");
+
+    // Returns the generated entry names relative to `baseDir`, without ".gpg"
+    QStringList generate(const QDir &baseDir) const;
+
+    // Builds a keystroke log that types fragments of existing entries, one
+    // line per state of the query line, including typos and backspaces.
+    static QStringList keystrokeLog(const QStringList &entries, int sessions, quint32 seed);
+};
+
+#endif
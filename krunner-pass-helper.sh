@@ -0,0 +1,93 @@
+#!/usr/bin/env bash
+# Long running helper for krunner-pass, keeps a warm process around so copying
+# a password only costs running gpg instead of starting pass, which is a shell
+# script itself, for every copy.
+#
+# Request:  "<show|otp>\t<entry>\n"
+# Response: "<exit code> <length>\n" followed by <length> bytes of output
+#
+# Exit code 125 means the helper can not handle the entry (e.g. HOTP, which
+# needs pass-otp to update the counter) and the caller should run pass itself.
+#
+# Setting $KRUNNER_PASS_COMMAND makes the helper run that command like pass
+# ("show <entry>", "otp show <entry>") instead, for stores that depend on pass
+# extensions. $KRUNNER_PASS_GPG and $KRUNNER_PASS_OATHTOOL replace gpg and
+# oathtool, e.g. with a test double.
+
+prefix=${PASSWORD_STORE_DIR:-$HOME/.password-store}
+command=$KRUNNER_PASS_COMMAND
+gpg=${KRUNNER_PASS_GPG:-gpg}
+if [[ -z $KRUNNER_PASS_GPG ]] && command -v gpg2 >/dev/null; then
+    gpg=gpg2
+fi
+oathtool=${KRUNNER_PASS_OATHTOOL:-oathtool}
+gpg_opts=(--decrypt --batch --quiet $PASSWORD_STORE_GPG_OPTS)
+
+# Sets $length to the size of $1 in bytes, without forking
+byte_length() {
+    local LC_ALL=C
+    length=${#1}
+}
+
+# Sets $value to the percent-decoded $1
+uri_decode() {
+    printf -v value '%b' "${1//%/\\x}"
+}
+
+# Sets $output to the code of the otpauth:// URI in $1. Anything beyond the
+# secret, digits and period, or a failing oathtool, is left to pass-otp.
+totp() {
+    local line uri secret digits=6 period=30 param value
+    while IFS= read -r line; do
+        if [[ $line == otpauth://totp/* ]]; then
+            uri=$line
+            break
+        fi
+    done <<< "$1"
+    [[ $uri == *\?* ]] || return 125
+
+    local IFS='&'
+    for param in ${uri#*\?}; do
+        uri_decode "${param#*=}"
+        case "$param" in
+            secret=*) secret=$value ;;
+            digits=*) digits=$value ;;
+            period=*) period=$value ;;
+            *) return 125 ;;
+        esac
+    done
+    [[ $secret =~ ^[A-Za-z2-7=]+$ && $digits =~ ^[0-9]+$ && $period =~ ^[0-9]+$ ]] || return 125
+
+    output=$(exec "$oathtool" --base32 --totp --digits="$digits" --time-step-size="${period}s" "$secret" 2>/dev/null) || return 125
+}
+
+# "exec" in the command substitutions saves bash a second fork per request
+while IFS=$'\t' read -r mode entry; do
+    if [[ -n $command ]]; then
+        case "$mode" in
+            show) output=$(exec "$command" show "$entry" 2>/dev/null); status=$? ;;
+            otp) output=$(exec "$command" otp show "$entry" 2>/dev/null); status=$? ;;
+            *) status=2 ;;
+        esac
+    else
+        case "$mode" in
+            show|otp) output=$(exec "$gpg" "${gpg_opts[@]}" "$prefix/$entry.gpg" 2>/dev/null); status=$? ;;
+            *) status=2 ;;
+        esac
+        if [[ $status -eq 0 && $mode == otp ]]; then
+            totp "$output"
+            status=$?
+        fi
+    fi
+
+    if [[ $status -ne 0 ]]; then
+        output=
+    elif [[ -n $output ]]; then
+        # Command substitution dropped the trailing newline
+        output+=$'\n'
+    fi
+    byte_length "$output"
+
+    printf '%d %d\n%s' "$status" "$length" "$output"
+    unset output
+done
@@ -22,8 +22,11 @@
 #include <QIcon>
 #include <QAction>
 #include <QDirIterator>
+#include <QFileInfo>
+#include <QElapsedTimer>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QThread>
 #include <QTimer>
 #include <QMessageBox>
 #include <QClipboard>
@@ -33,8 +36,10 @@
 #include <QApplication>
 
 #include <cstdlib>
+#include <memory>
 
 #include "pass.h"
+#include "passhelperpool.h"
 #include "config.h"
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -61,7 +66,18 @@ Pass::Pass(QObject *parent, const KPluginMetaData &metaData, const QVariantList
 #endif
 }
 
-Pass::~Pass() = default;
+Pass::~Pass()
+{
+    if (helperPool) {
+        // Pending replies must not reach this runner anymore
+        helperPool->cancel();
+        if (helperPool->thread() == QThread::currentThread()) {
+            delete helperPool;
+        } else {
+            helperPool->deleteLater();
+        }
+    }
+}
 
 void Pass::reloadConfiguration()
 {
@@ -144,12 +160,27 @@ void Pass::init()
     }
 
     initPasswords();
+    if (inKRunner) {
+        stats.registerOnBus();
+    }
+
+    // Without the helper every copy starts "pass" from scratch. run() is
+    // called from the GUI thread, which may not be the one init() runs in,
+    // so the helpers and their replies are moved there.
+    const QFileInfo helper(QStringLiteral(KRUNNER_PASS_HELPER));
+    if (inKRunner && helper.isExecutable()) {
+        helperPool = new PassHelperPool(helper.absoluteFilePath());
+        helperPool->moveToThread(QCoreApplication::instance()->thread());
+        QMetaObject::invokeMethod(helperPool, &PassHelperPool::warmUp, Qt::QueuedConnection);
+    }
 
     connect(&watcher, &QFileSystemWatcher::directoryChanged, this, &Pass::reinitPasswords);
 }
 
 void Pass::initPasswords()
 {
+    QElapsedTimer timer;
+    timer.start();
     passwords.clear();
 
     watcher.addPath(this->baseDir.absolutePath());
@@ -166,12 +197,17 @@ void Pass::initPasswords()
             watcher.addPath(it.filePath());
         }
     }
+
+    stats.indexEntries = passwords.size();
+    stats.indexWatches = watcher.directories().size();
+    stats.indexBuild.record(timer.nsecsElapsed());
 }
 
 void Pass::reinitPasswords(const QString &path)
 {
     Q_UNUSED(path)
 
+    ++stats.watcherEvents;
     lock.lockForWrite();
     initPasswords();
     lock.unlock();
@@ -179,7 +215,9 @@ void Pass::reinitPasswords(const QString &path)
 
 void Pass::match(KRunner::RunnerContext &context)
 {
+    ++stats.queries;
     if (!context.isValid()) {
+        ++stats.rejectedQueries;
         return;
     }
 
@@ -188,10 +226,13 @@ void Pass::match(KRunner::RunnerContext &context)
     if (input.contains(queryPrefix)) {
         input = input.remove(QLatin1String("pass")).simplified();
     } else if (input.count() < 3 && !context.singleRunnerQueryMode()) {
+        ++stats.rejectedQueries;
         return;
     }
 
     QList<KRunner::QueryMatch> matches;
+    QElapsedTimer timer;
+    timer.start();
 
     lock.lockForRead();
     for (const auto &password: qAsConst(passwords)) {
@@ -206,11 +247,15 @@ void Pass::match(KRunner::RunnerContext &context)
     }
     lock.unlock();
 
+    stats.match.record(timer.nsecsElapsed());
+    stats.queryHits += matches.size();
     context.addMatches(matches);
 }
 
 void Pass::clip(const QString &msg)
 {
+    QElapsedTimer timer;
+    timer.start();
     auto md = new QMimeData;
     auto kc = KSystemClipboard::instance();
     // https://phabricator.kde.org/D12539
@@ -220,6 +265,7 @@ void Pass::clip(const QString &msg)
     QTimer::singleShot(timeout * 1000, kc, [kc]() {
         kc->clear(QClipboard::Clipboard);
     });
+    stats.clipboard.record(timer.nsecsElapsed());
 }
 
 void Pass::run(const KRunner::RunnerContext &context, const KRunner::QueryMatch &match)
@@ -228,62 +274,100 @@ void Pass::run(const KRunner::RunnerContext &context, const KRunner::QueryMatch
     const auto regexp = QRegularExpression("^" + QRegularExpression::escape(this->passOtpIdentifier) + ".*");
     const auto isOtp = !match.text().split('/').filter(regexp).isEmpty();
 
+    if (helperPool) {
+        helperPool->request(match.text(), isOtp ? PassHelperPool::Mode::Otp : PassHelperPool::Mode::Show,
+                            [this, match, isOtp](const PassHelperPool::Reply &reply) {
+                                stats.queue.record(reply.queuedNsecs);
+                                if (reply.exitCode == -1 && !reply.crashed) {
+                                    // No helper could do it, pass itself might
+                                    startPass(match, isOtp);
+                                    return;
+                                }
+                                stats.decrypt.record(reply.nsecs);
+                                if (reply.exitCode == 0) {
+                                    handleOutput(match, reply.output);
+                                } else {
+                                    ++stats.runFailures;
+                                }
+                            });
+    } else {
+        startPass(match, isOtp);
+    }
+}
+
+void Pass::startPass(const KRunner::QueryMatch &match, bool isOtp)
+{
     auto *pass = new QProcess();
     QStringList args;
     if (isOtp) {
         args << "otp";
     }
     args << "show" << match.text();
+
+    // Time until the process got exec'ed, decrypting is measured from there
+    auto timer = std::make_shared<QElapsedTimer>();
+    connect(pass, &QProcess::started, [this, timer]() {
+        stats.spawn.record(timer->nsecsElapsed());
+        timer->restart();
+    });
+    timer->start();
     pass->start("pass", args);
 
     connect(pass, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
             [=](int exitCode, QProcess::ExitStatus exitStatus) {
                 Q_UNUSED(exitStatus)
 
+                stats.decrypt.record(timer->nsecsElapsed());
                 if (exitCode == 0) {
-                    const auto output = pass->readAllStandardOutput();
-                    if (match.selectedAction()) {
-                        const auto data =
+                    handleOutput(match, pass->readAllStandardOutput());
+                } else {
+                    ++stats.runFailures;
+                }
+
+                pass->close();
+                pass->deleteLater();
+            });
+}
+
+void Pass::handleOutput(const KRunner::QueryMatch &match, const QByteArray &output)
+{
+    if (match.selectedAction()) {
+        const auto data =
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-                            match.selectedAction()->data().toString();
+            match.selectedAction()->data().toString();
 #else
-                        match.selectedAction().id();
+        match.selectedAction().id();
 #endif
-                        if (data == Config::showFileContentAction) {
-                            QMessageBox::information(nullptr, match.text(), output);
-                        } else {
-                            QRegularExpression re(data, QRegularExpression::MultilineOption);
-                            const auto matchre = re.match(output);
-
-                            if (matchre.hasMatch()) {
-                                clip(matchre.captured(1));
-                                this->showNotification(match.text(),
+        if (data == Config::showFileContentAction) {
+            QMessageBox::information(nullptr, match.text(), output);
+        } else {
+            QRegularExpression re(data, QRegularExpression::MultilineOption);
+            const auto matchre = re.match(output);
+
+            if (matchre.hasMatch()) {
+                clip(matchre.captured(1));
+                this->showNotification(match.text(),
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-                                                       match.selectedAction()->text());
+                                       match.selectedAction()->text());
 #else
-                                match.selectedAction().text());
+                match.selectedAction().text());
 #endif
-                            } else {
-                                // Show some information to understand what went wrong.
-                                qInfo() << "Regexp: " << data;
-                                qInfo() << "Is regexp valid? " << re.isValid();
-                                qInfo() << "The file: " << match.text();
-                                // qInfo() << "Content: " << output;
-                            }
-                        }
-                    } else {
-                        const auto string = QString::fromUtf8(output.data());
-                        const auto lines = string.split('\n', Qt::SkipEmptyParts);
-                        if (!lines.isEmpty()) {
-                            clip(lines[0]);
-                            this->showNotification(match.text());
-                        }
-                    }
-                }
-
-                pass->close();
-                pass->deleteLater();
-            });
+            } else {
+                // Show some information to understand what went wrong.
+                qInfo() << "Regexp: " << data;
+                qInfo() << "Is regexp valid? " << re.isValid();
+                qInfo() << "The file: " << match.text();
+                // qInfo() << "Content: " << output;
+            }
+        }
+    } else {
+        const auto string = QString::fromUtf8(output.data());
+        const auto lines = string.split('\n', Qt::SkipEmptyParts);
+        if (!lines.isEmpty()) {
+            clip(lines[0]);
+            this->showNotification(match.text());
+        }
+    }
 }
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 QList<QAction *> Pass::actionsForMatch(const Plasma::QueryMatch &match)
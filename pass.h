@@ -39,6 +39,10 @@ class Action;
 #include <QFileSystemWatcher>
 #include <QRegularExpression>
 
+#include "passstats.h"
+
+class PassHelperPool;
+
 class Pass : public KRunner::AbstractRunner
 {
     Q_OBJECT
@@ -64,6 +68,13 @@ protected:
     void init() override;
     void initPasswords();
     void showNotification(const QString &, const QString & = QString());
+    void startPass(const KRunner::QueryMatch &, bool isOtp);
+    void handleOutput(const KRunner::QueryMatch &, const QByteArray &);
+
+    const PassStats &statistics() const { return stats; }
+    // Off for the benchmark, which runs without krunner around it: no
+    // statistics on D-Bus and no helper processes
+    bool inKRunner = true;
 
 private:
     QDir baseDir;
@@ -72,6 +83,8 @@ private:
     QReadWriteLock lock;
     QList<QString> passwords;
     QFileSystemWatcher watcher;
+    PassStats stats;
+    PassHelperPool *helperPool = nullptr;
     
     bool showActions;
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
@@ -0,0 +1,274 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#include <QDebug>
+#include <QProcess>
+#include <QTimer>
+
+#include "passhelperpool.h"
+
+namespace {
+// Exit code of the helper for entries it can not handle, see krunner-pass-helper.sh
+constexpr int Unsupported = 125;
+}
+
+PassHelperPool::PassHelperPool(const QString &program, QObject *parent)
+    : QObject(parent)
+    , program(program)
+    , environment(QProcessEnvironment::systemEnvironment())
+{
+}
+
+PassHelperPool::~PassHelperPool()
+{
+    stopping = true;
+    for (auto *helper: qAsConst(helpers)) {
+        helper->process->disconnect(this);
+        // The helper exits once stdin is closed
+        helper->process->closeWriteChannel();
+        if (!helper->process->waitForFinished(500)) {
+            helper->process->kill();
+            helper->process->waitForFinished(500);
+        }
+        delete helper;
+    }
+}
+
+void PassHelperPool::setMaxHelpers(int count)
+{
+    maxHelpers = qMax(1, count);
+}
+
+void PassHelperPool::setIdleTimeout(int msecs)
+{
+    idleTimeout = msecs;
+    for (auto *helper: qAsConst(helpers)) {
+        helper->idleTimer->setInterval(msecs);
+    }
+}
+
+void PassHelperPool::setProcessEnvironment(const QProcessEnvironment &environment)
+{
+    this->environment = environment;
+}
+
+void PassHelperPool::warmUp()
+{
+    if (helpers.isEmpty() && !stopping) {
+        spawn();
+    }
+}
+
+void PassHelperPool::request(const QString &entry, Mode mode, const Callback &callback)
+{
+    // Entries are sent as one line
+    if (entry.contains(QLatin1Char('\n'))) {
+        callback(Reply());
+        return;
+    }
+
+    Request request;
+    request.entry = entry;
+    request.mode = mode;
+    request.callback = callback;
+    request.timer.start();
+    queue.enqueue(request);
+    dispatch();
+}
+
+void PassHelperPool::cancel()
+{
+    stopping = true;
+    queue.clear();
+    for (auto *helper: qAsConst(helpers)) {
+        helper->current.reset();
+        helper->retiring = true;
+    }
+}
+
+int PassHelperPool::helperCount() const
+{
+    return helpers.size();
+}
+
+int PassHelperPool::spawnedHelpers() const
+{
+    return spawned;
+}
+
+PassHelperPool::Helper *PassHelperPool::spawn()
+{
+    auto *helper = new Helper;
+    helper->process = new QProcess(this);
+    helper->process->setProcessEnvironment(environment);
+    helper->process->setReadChannel(QProcess::StandardOutput);
+    // Nobody reads it, it would pile up for the whole life of the helper
+    helper->process->setStandardErrorFile(QProcess::nullDevice());
+
+    helper->idleTimer = new QTimer(helper->process);
+    helper->idleTimer->setSingleShot(true);
+    helper->idleTimer->setInterval(idleTimeout);
+    connect(helper->idleTimer, &QTimer::timeout, this, [helper]() {
+        if (!helper->current) {
+            helper->retiring = true;
+            helper->process->closeWriteChannel();
+        }
+    });
+
+    connect(helper->process, &QProcess::readyReadStandardOutput, this, [this, helper]() {
+        readReply(helper);
+    });
+    connect(helper->process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, [this, helper]() {
+                helperFinished(helper);
+            });
+    // Queued, start() may report the error before spawn() returned the helper
+    connect(helper->process, &QProcess::errorOccurred, this, [this, helper](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            helperFailed(helper);
+        }
+    }, Qt::QueuedConnection);
+
+    helpers << helper;
+    ++spawned;
+    // Writes are buffered until the process is running
+    helper->process->start(program, QStringList());
+    helper->idleTimer->start();
+    return helper;
+}
+
+void PassHelperPool::dispatch()
+{
+    while (!queue.isEmpty()) {
+        Helper *idle = nullptr;
+        for (auto *helper: qAsConst(helpers)) {
+            if (!helper->current && !helper->retiring && helper->process->state() != QProcess::NotRunning) {
+                idle = helper;
+                break;
+            }
+        }
+        if (!idle && helpers.size() < maxHelpers) {
+            idle = spawn();
+        }
+        if (!idle) {
+            return;
+        }
+        send(idle, queue.dequeue());
+    }
+}
+
+void PassHelperPool::send(Helper *helper, Request request)
+{
+    helper->idleTimer->stop();
+    request.queuedNsecs += request.timer.nsecsElapsed();
+    request.timer.restart();
+
+    QByteArray line = request.mode == Mode::Otp ? "otp\t" : "show\t";
+    line += request.entry.toUtf8();
+    line += '\n';
+    helper->current = request;
+    helper->process->write(line);
+}
+
+void PassHelperPool::readReply(Helper *helper)
+{
+    helper->buffer += helper->process->readAllStandardOutput();
+
+    const auto headerEnd = helper->buffer.indexOf('\n');
+    if (headerEnd < 0 || !helper->current) {
+        return;
+    }
+    const auto header = helper->buffer.left(headerEnd).split(' ');
+    const int length = header.value(1).toInt();
+    if (helper->buffer.size() < headerEnd + 1 + length) {
+        return;
+    }
+
+    Reply reply;
+    reply.exitCode = header.value(0).toInt();
+    if (reply.exitCode == Unsupported) {
+        reply.exitCode = -1;
+    }
+    reply.output = helper->buffer.mid(headerEnd + 1, length);
+    reply.queuedNsecs = helper->current->queuedNsecs;
+    reply.nsecs = helper->current->timer.nsecsElapsed();
+    helper->buffer.remove(0, headerEnd + 1 + length);
+
+    const auto callback = helper->current->callback;
+    helper->current.reset();
+    helper->idleTimer->start();
+
+    callback(reply);
+    dispatch();
+}
+
+void PassHelperPool::helperFinished(Helper *helper)
+{
+    auto request = helper->current;
+    remove(helper);
+
+    if (request) {
+        // Showing has no side effects, otp may bump a HOTP counter and
+        // extensions can do anything, those are not run a second time
+        if (request->mode == Mode::Show && !request->retried) {
+            request->retried = true;
+            request->queuedNsecs += request->timer.nsecsElapsed();
+            request->timer.restart();
+            queue.prepend(*request);
+        } else {
+            qWarning() << "pass helper died while handling" << request->entry;
+            Reply reply;
+            reply.crashed = true;
+            reply.queuedNsecs = request->queuedNsecs;
+            request->callback(reply);
+        }
+    }
+
+    // Keep one warm helper around, be it after a crash or the idle timeout
+    if (helpers.isEmpty() && !stopping) {
+        spawn();
+    }
+    dispatch();
+}
+
+void PassHelperPool::helperFailed(Helper *helper)
+{
+    qWarning() << "Could not start pass helper" << program << helper->process->errorString();
+
+    // Starting a new one is not going to work either, fail everything
+    auto pending = queue;
+    queue.clear();
+    if (helper->current) {
+        pending.prepend(*helper->current);
+    }
+    remove(helper);
+
+    for (const auto &request: qAsConst(pending)) {
+        request.callback(Reply());
+    }
+}
+
+void PassHelperPool::remove(Helper *helper)
+{
+    helpers.removeOne(helper);
+    helper->idleTimer->stop();
+    helper->idleTimer->disconnect(this);
+    helper->process->disconnect(this);
+    helper->process->deleteLater();
+    delete helper;
+}
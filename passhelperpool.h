@@ -0,0 +1,119 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#ifndef PASSHELPERPOOL_H
+#define PASSHELPERPOOL_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QProcessEnvironment>
+#include <QQueue>
+
+#include <functional>
+#include <optional>
+
+class QProcess;
+class QTimer;
+
+// Keeps a few krunner-pass-helper processes running and hands requests to
+// them, see krunner-pass-helper.sh for the protocol. Up to maxHelpers are
+// started on demand, one warm helper is always kept: helpers idle for longer
+// than the idle timeout are stopped and the last one is replaced by a fresh
+// process, as is a crashed one. A "show" request is retried once after a
+// crash.
+class PassHelperPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Mode {
+        Show,
+        Otp,
+    };
+
+    struct Reply {
+        // -1 if no helper could answer the request: it could not be started,
+        // does not support the entry or crashed, see `crashed`
+        int exitCode = -1;
+        // The helper died while handling the request, running it somewhere
+        // else again is not safe for otp and extensions
+        bool crashed = false;
+        QByteArray output;
+        // Time spent waiting for a helper and time the helper took, the
+        // latter is 0 if no helper answered
+        qint64 queuedNsecs = 0;
+        qint64 nsecs = 0;
+    };
+    using Callback = std::function<void(const Reply &)>;
+
+    explicit PassHelperPool(const QString &program, QObject *parent = nullptr);
+    ~PassHelperPool() override;
+
+    void setMaxHelpers(int count);
+    void setIdleTimeout(int msecs);
+    void setProcessEnvironment(const QProcessEnvironment &environment);
+
+    // Starts a helper ahead of the first request
+    void warmUp();
+    // Callbacks are invoked in the thread the pool lives in
+    void request(const QString &entry, Mode mode, const Callback &callback);
+    // Drops all pending callbacks and stops replacing helpers, for shutdown
+    void cancel();
+
+    int helperCount() const;
+    int spawnedHelpers() const;
+
+private:
+    struct Request {
+        QString entry;
+        Mode mode;
+        Callback callback;
+        QElapsedTimer timer;
+        qint64 queuedNsecs = 0;
+        bool retried = false;
+    };
+
+    struct Helper {
+        QProcess *process = nullptr;
+        QTimer *idleTimer = nullptr;
+        QByteArray buffer;
+        std::optional<Request> current;
+        // Stdin got closed after the idle timeout, the helper is about to exit
+        bool retiring = false;
+    };
+
+    Helper *spawn();
+    void dispatch();
+    void send(Helper *helper, Request request);
+    void readReply(Helper *helper);
+    void helperFinished(Helper *helper);
+    void helperFailed(Helper *helper);
+    void remove(Helper *helper);
+
+    QString program;
+    QProcessEnvironment environment;
+    int maxHelpers = 2;
+    int idleTimeout = 5 * 60 * 1000;
+    int spawned = 0;
+    bool stopping = false;
+    QList<Helper *> helpers;
+    QQueue<Request> queue;
+};
+
+#endif
@@ -0,0 +1,147 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#include <QDBusConnection>
+#include <QDBusError>
+#include <QDebug>
+#include <QtAlgorithms>
+
+#include "passstats.h"
+
+Q_LOGGING_CATEGORY(KRUNNER_PASS_STATS, "krunner_pass.stats", QtInfoMsg)
+
+void LatencyHistogram::record(qint64 nsecs)
+{
+    const auto ns = quint64(qMax<qint64>(nsecs, 0));
+    const auto us = ns / 1000;
+    const int index = us == 0 ? 0 : qMin(Buckets - 1, 64 - int(qCountLeadingZeroBits(us)));
+
+    buckets[index].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sumNs.fetch_add(ns, std::memory_order_relaxed);
+    auto max = maxNs.load(std::memory_order_relaxed);
+    while (ns > max && !maxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket: buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sumNs.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+}
+
+quint64 LatencyHistogram::count() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+quint64 LatencyHistogram::percentileUs(double p) const
+{
+    const auto n = count();
+    if (n == 0) {
+        return 0;
+    }
+
+    const auto rank = quint64(p * (n - 1)) + 1;
+    quint64 seen = 0;
+    for (int i = 0; i < Buckets; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return quint64(1) << i;
+        }
+    }
+    return maxNs.load(std::memory_order_relaxed) / 1000;
+}
+
+QVariantMap LatencyHistogram::toVariantMap() const
+{
+    const auto n = count();
+    return {
+        {QStringLiteral("count"), n},
+        {QStringLiteral("avg_us"), n ? sumNs.load(std::memory_order_relaxed) / n / 1000 : 0},
+        {QStringLiteral("max_us"), maxNs.load(std::memory_order_relaxed) / 1000},
+        {QStringLiteral("p50_us"), percentileUs(0.50)},
+        {QStringLiteral("p99_us"), percentileUs(0.99)},
+    };
+}
+
+void PassStats::registerOnBus()
+{
+    auto bus = QDBusConnection::sessionBus();
+    if (!bus.registerObject(QStringLiteral("/krunner_pass"), this, QDBusConnection::ExportScriptableSlots)) {
+        qCWarning(KRUNNER_PASS_STATS) << "Could not register statistics on the session bus" << bus.lastError().message();
+    }
+}
+
+QVariantMap PassStats::Counters() const
+{
+    return {
+        {QStringLiteral("index_build"), indexBuild.toVariantMap()},
+        {QStringLiteral("index_entries"), indexEntries.load()},
+        {QStringLiteral("index_watches"), indexWatches.load()},
+        {QStringLiteral("watcher_events"), watcherEvents.load()},
+        {QStringLiteral("queries"), queries.load()},
+        {QStringLiteral("queries_rejected"), rejectedQueries.load()},
+        {QStringLiteral("match"), match.toVariantMap()},
+        {QStringLiteral("query_hits"), queryHits.load()},
+        {QStringLiteral("run_queue"), queue.toVariantMap()},
+        {QStringLiteral("run_spawn"), spawn.toVariantMap()},
+        {QStringLiteral("run_decrypt"), decrypt.toVariantMap()},
+        {QStringLiteral("run_clipboard"), clipboard.toVariantMap()},
+        {QStringLiteral("run_failures"), runFailures.load()},
+    };
+}
+
+QString PassStats::Dump() const
+{
+    QString text;
+    const auto counters = Counters();
+    for (auto it = counters.cbegin(); it != counters.cend(); ++it) {
+        if (it.value().userType() == QMetaType::QVariantMap) {
+            const auto histogram = it.value().toMap();
+            text += QStringLiteral("%1: count=%2 avg=%3us p50<=%4us p99<=%5us max=%6us\n")
+                        .arg(it.key())
+                        .arg(histogram.value(QStringLiteral("count")).toULongLong())
+                        .arg(histogram.value(QStringLiteral("avg_us")).toULongLong())
+                        .arg(histogram.value(QStringLiteral("p50_us")).toULongLong())
+                        .arg(histogram.value(QStringLiteral("p99_us")).toULongLong())
+                        .arg(histogram.value(QStringLiteral("max_us")).toULongLong());
+        } else {
+            text += QStringLiteral("%1: %2\n").arg(it.key()).arg(it.value().toULongLong());
+        }
+    }
+
+    qCInfo(KRUNNER_PASS_STATS).noquote() << text;
+    return text;
+}
+
+void PassStats::Reset()
+{
+    for (auto *histogram: {&indexBuild, &match, &queue, &spawn, &decrypt, &clipboard}) {
+        histogram->reset();
+    }
+    watcherEvents = 0;
+    queries = 0;
+    rejectedQueries = 0;
+    queryHits = 0;
+    runFailures = 0;
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+ *  Copyright (C) 2026 by the krunner-pass developers                         *
+ *                                                                            *
+ *  This library is free software; you can redistribute it and/or modify      *
+ *  it under the terms of the GNU General Public License as published         *
+ *  by the Free Software Foundation; either version 3 of the License or (at   *
+ *  your option) any later version.                                           *
+ *                                                                            *
+ *  This library is distributed in the hope that it will be useful,           *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU         *
+ *  Library General Public License for more details.                          *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with this library; see the file LICENSE.                            *
+ *  If not, see <http://www.gnu.org/licenses/>.                               *
+ *****************************************************************************/
+
+#ifndef PASSSTATS_H
+#define PASSSTATS_H
+
+#include <QLoggingCategory>
+#include <QObject>
+#include <QVariantMap>
+
+#include <array>
+#include <atomic>
+
+Q_DECLARE_LOGGING_CATEGORY(KRUNNER_PASS_STATS)
+
+// Lock free latency histogram with power of two buckets in microseconds,
+// cheap enough to be recorded on every query from the match threads.
+class LatencyHistogram
+{
+public:
+    void record(qint64 nsecs);
+    void reset();
+
+    quint64 count() const;
+    // Upper bound of the bucket containing the p-th sample
+    quint64 percentileUs(double p) const;
+    QVariantMap toVariantMap() const;
+
+private:
+    static constexpr int Buckets = 32;
+    std::array<std::atomic<quint64>, Buckets> buckets{};
+    std::atomic<quint64> total{0};
+    std::atomic<quint64> sumNs{0};
+    std::atomic<quint64> maxNs{0};
+};
+
+// Counters of the runner hot paths, exported on the session bus of the
+// krunner process at /krunner_pass:
+//   qdbus org.kde.krunner /krunner_pass org.kde.krunner.pass.Stats.Dump
+class PassStats : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.krunner.pass.Stats")
+
+public:
+    using QObject::QObject;
+
+    void registerOnBus();
+
+    LatencyHistogram indexBuild;
+    std::atomic<quint64> indexEntries{0};
+    std::atomic<quint64> indexWatches{0};
+    std::atomic<quint64> watcherEvents{0};
+
+    // Every call of match(), rejected ones are too short or invalid and
+    // are not part of the histogram
+    std::atomic<quint64> queries{0};
+    std::atomic<quint64> rejectedQueries{0};
+    LatencyHistogram match;
+    std::atomic<quint64> queryHits{0};
+
+    // Phases of Pass::run: waiting for a free helper process, starting pass
+    // until exec (only without helper), decrypting, setting the clipboard
+    LatencyHistogram queue;
+    LatencyHistogram spawn;
+    LatencyHistogram decrypt;
+    LatencyHistogram clipboard;
+    std::atomic<quint64> runFailures{0};
+
+public Q_SLOTS:
+    Q_SCRIPTABLE QVariantMap Counters() const;
+    // Returns a human readable dump and writes it to the krunner_pass.stats category
+    Q_SCRIPTABLE QString Dump() const;
+    Q_SCRIPTABLE void Reset();
+};
+
+#endif